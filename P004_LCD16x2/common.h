@@ -11,7 +11,8 @@
  *
  * Hardware setup:	
  *
- * Releases:		Oct 18 2015 - 1.2:		Changed the SET and CLEAR bit-macro functions
+ * Releases:		Oct 18 2026 - 1.3:		Added SET and CLEAR mask-macro functions, removed unused PinSettings structure
+ *				Oct 18 2015 - 1.2:		Changed the SET and CLEAR bit-macro functions
  *				Oct 9 2015 - 1.1:		Added High - Low defines
  *				
  *				Oct. 1 2015 - 1.0		Initial release
@@ -35,24 +36,16 @@ typedef	uint8_t		BOOL;
 #define HIGH		1
 #define LOW			0
 
-/************************************************************************/
-/* Structures				                                                                  */
-/************************************************************************/
-struct PinSettings
-{
-	volatile BYTE* outputPort;
-	volatile BYTE* inputPort;
-	volatile BYTE* dirPort;
-	volatile BYTE pin;
-};
-
-
 /************************************************************************/
 /* Macros				                                                                  */
 /************************************************************************/
 #define SET_BIT(outputPort, inputPort, bit)       ( *outputPort =  (*inputPort | (1 << bit)) )
 #define CLEAR_BIT(outputPort, inputPort, bit)     ( *outputPort =  (*inputPort & ~(1 << bit)) )
 
+/* Same as above, but with a precalculated mask (1 << bit) and a read-modify-write of the output port */
+#define SET_MASK(outputPort, mask)                ( *outputPort |= (mask) )
+#define CLEAR_MASK(outputPort, mask)              ( *outputPort &= ~(mask) )
+
 
 /************************************************************************/
 /* Function Prototypes		                                                                  */
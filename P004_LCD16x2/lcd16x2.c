@@ -7,10 +7,16 @@
  * Name:    		lcd16x2.c
  * Purpose: 		LCD 16x2 Library
  * Date:			01-10-2015
- * Version:		1.0	
+ * Version:		1.6	
  * Author:		Marcel van der Ven
  *
  * Release notes:	Oct. 10, 2015:	1.0 - Initial Release
+ *				Oct. 18, 2026:	1.1 - Added non-waiting write and busy flag poll for the task driver
+ *				Oct. 18, 2026:	1.2 - Added DDRAM shadow and bulk DDRAM/CGRAM read functions
+ *				Oct. 18, 2026:	1.3 - Added RestoreDisplay to recover from an LCD reset
+ *				Oct. 18, 2026:	1.4 - WriteToPosition and ClearCharacter support frame coalescing
+ *				Oct. 18, 2026:	1.5 - Added UpdateCharacter and WriteCharacter
+ *				Oct. 18, 2026:	1.6 - Packed the LCD structure, shared control port and precalculated pin masks
  *
  * Note(s):
  *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
@@ -22,6 +28,14 @@
 #define CLEAR_LCD		0b00000001
 #define RETURN_HOME		0b00000010
 #define CLEAR_CHAR		0x20
+#define FUNCTION_SET		0b00100000
+#define FUNCTION_SET_MASK	0b11100000
+#define LINE1_END_ADDRESS	0x27
+#define LINE2_START_ADDRESS	0x40
+#define LINE2_END_ADDRESS	0x67
+#define ONE_LINE_END_ADDRESS	0x4F
+#define TWO_LINES_BIT		0b00001000
+#define ENTRY_MODE_INCREMENT	0b00000110
 
 /************************************************************************/
 /* Includes				                                                                  */
@@ -31,6 +45,10 @@
 #include "lcd16x2.h"
 #include "string.h"
 
+#if LCD_FEATURE_COALESCING
+#include "lcd16x2_frame.h"
+#endif
+
 
 /************************************************************************/
 /* Structures				                                                                  */
@@ -40,19 +58,46 @@ struct Lcd16x2
 	volatile uint8_t* dataOutputPortRegister;
 	volatile uint8_t* dataInputPortRegister;
 	volatile uint8_t* dataDirRegister;
-	struct PinSettings rs;
-	struct PinSettings rw;
-	struct PinSettings enable;
+	
+	/* RS, RW and Enable share one port, the pin masks are calculated once at initialization */
+	volatile uint8_t* controlPortRegister;
+	BYTE rsMask;
+	BYTE rwMask;
+	BYTE enableMask;
 	
 	/* Specifies if the LCD structure is initialized, it can only be used when its initialized */
-	BOOL initialized;
+	BOOL initialized : 1;
 	
 	/* Specifies if the setup-phase of the LCD is completed (this happens after FunctionSet is called) */
 	/* Afterwards we can poll the BusyFlag */
-	BOOL setupCompleted;
+	BOOL setupCompleted : 1;
+	
+	/* Specifies if the address counter points to CGRAM instead of DDRAM */
+	BOOL cgramSelected : 1;
+	
+	/* Specifies if the address counter decrements after a data access (see SetEntryMode) */
+	BOOL decrement : 1;
+	
+	/* Copy of the address counter, it is updated on every write and data read */
+	BYTE address;
+	
+	/* Shadow of the visible DDRAM content, it holds what the driver has written to the display */
+	BYTE shadow[2][LINE_LENGTH];
+	
+	/* Last written configuration instructions, used to restore the LCD after a reset */
+	BYTE functionSet;
+	BYTE displayControl;
+	BYTE entryMode;
 } lcd;
 
 
+/************************************************************************/
+/* Local Function Prototypes		                                                                  */
+/************************************************************************/
+static void TrackInstruction(BYTE instruction);
+static void AdvanceAddress(void);
+
+
 /************************************************************************/
 /* Functions				                                                                  */
 /************************************************************************/	
@@ -78,6 +123,18 @@ void WriteToPosition(char* string, BYTE line, BYTE pos, BYTE positionsToClear)
 		/* If we want to write to position 10 then we can write 7 characters, so the string should not be greater then 7 characters */
 		if(length <= (16 - pos))
 		{
+#if LCD_FEATURE_COALESCING
+			/* When coalescing, only the final character of every position is marked and sent at the next frame */
+			if(IsCoalescingEnabled() == TRUE)
+			{
+				for(int i = 0; i < length || i < positionsToClear; i++)
+				{
+					SubmitCharacter(line, pos + i, (i < length) ? string[i] : CLEAR_CHAR);
+				}
+				return;
+			}
+#endif
+			
 			/* First clear the characters, from position till number of positionsToClear */
 			for(int i = pos; i < (pos + positionsToClear); i++)
 			{
@@ -113,6 +170,14 @@ void ClearCharacter(BYTE line, BYTE pos)
 	/* Check if the line is smaller then 2 and the position smaller then 17 */
 	if(!(line > 2 || pos > 16))
 	{
+#if LCD_FEATURE_COALESCING
+		if(IsCoalescingEnabled() == TRUE)
+		{
+			SubmitCharacter(line, pos, CLEAR_CHAR);
+			return;
+		}
+#endif
+		
 		/* Line 1 is address 0x00 till 0x27 */
 		/* Line 2 is address 0x40 till  0x67 */
 		/* Set line mask, bit 6 is 0 for line 1 and 1 for line 2 */
@@ -129,6 +194,64 @@ void ClearCharacter(BYTE line, BYTE pos)
 	}
 }
 
+/***************************************************************************
+*  Function:		UpdateCharacter(BYTE line, BYTE pos, BYTE character)
+*  Description:		Writes the given character to the given line and position, but only when the
+				display does not already show it. The address is only set when the address
+				counter does not already point to the position, so updating adjacent
+				characters costs one write each.
+*  Receives:		BYTE line			:	The line to write to.
+				BYTE pos			:	The position on the line (zero-based)
+				BYTE character		:	The character to write.
+*  Returns:		Nothing
+***************************************************************************/
+void UpdateCharacter(BYTE line, BYTE pos, BYTE character)
+{
+	if(line < LINE1 || line > LINE2 || pos >= LINE_LENGTH)
+		return;
+	
+#if LCD_FEATURE_COALESCING
+	if(IsCoalescingEnabled() == TRUE)
+	{
+		SubmitCharacter(line, pos, character);
+		return;
+	}
+#endif
+	
+	if(lcd.shadow[line-1][pos] == character)
+		return;
+	
+	WriteCharacter(line, pos, character);
+}
+
+/***************************************************************************
+*  Function:		WriteCharacter(BYTE line, BYTE pos, BYTE character)
+*  Description:		Writes the given character to the given line and position. The address is only
+				set when the address counter does not already point to the position.
+*  Receives:		BYTE line			:	The line to write to.
+				BYTE pos			:	The position on the line (zero-based)
+				BYTE character		:	The character to write.
+*  Returns:		Number of bus transactions used, 1 or 2. 0 when the line or position is invalid.
+***************************************************************************/
+BYTE WriteCharacter(BYTE line, BYTE pos, BYTE character)
+{
+	if(line < LINE1 || line > LINE2 || pos >= LINE_LENGTH)
+		return 0;
+	
+	BYTE transactions = 1;
+	BYTE address = ((line-1) << 6) + pos;
+	
+	if(lcd.cgramSelected == TRUE || lcd.address != address)
+	{
+		SetDisplayDataAddress(address);
+		transactions++;
+	}
+	
+	WriteDataReg(character);
+	
+	return transactions;
+}
+
 /***************************************************************************
 *  Function:		WriteNewLine(char* string, BYTE line)
 *  Description:		Writes the given string to the given line, 
@@ -157,7 +280,7 @@ void WriteNewLine(char* string, BYTE line)
 				BYTE* dataInputPortReg		:	Data input port register
 				BYTE* dataDirReg			:	Data direction register
 				BYTE* controlOutputPortReg	:	Control output port register
-				BYTE* controlInputPortReg	:	Control input port register			
+				BYTE* controlInputPortReg	:	Control input port register (not used anymore)			
 				BYTE rsPin,				:	RS pin number	
 				BYTE rwPin				:	RW pin number		
 				BYTE enablePin				:	Enable pin number
@@ -176,15 +299,16 @@ void InitializeLcd(volatile BYTE* dataOutputPortReg,
 	lcd.dataInputPortRegister = dataInputPortReg;
 	lcd.dataDirRegister = dataDirReg;
 	
-	lcd.rs.outputPort = controlOutputPortReg;
-	lcd.rs.inputPort = controlInputPortReg;
-	lcd.rs.pin = rsPin;
-	lcd.rw.outputPort = controlOutputPortReg;
-	lcd.rw.inputPort = controlInputPortReg;
-	lcd.rw.pin = rwPin;
-	lcd.enable.outputPort = controlOutputPortReg;
-	lcd.enable.inputPort = controlInputPortReg;
-	lcd.enable.pin = enablePin;
+	/* The control pins are changed with a read-modify-write of the output register, */
+	/* so the input register is not needed */
+	(void)controlInputPortReg;
+	lcd.controlPortRegister = controlOutputPortReg;
+	lcd.rsMask = 1 << rsPin;
+	lcd.rwMask = 1 << rwPin;
+	lcd.enableMask = 1 << enablePin;
+	
+	/* The display content is unknown, assume it is cleared */
+	memset(lcd.shadow, CLEAR_CHAR, sizeof(lcd.shadow));
 	
 	/* Set boolean to indicate LCD struct is initialized */
 	lcd.initialized = TRUE;
@@ -200,6 +324,7 @@ void InitializeLcd(volatile BYTE* dataOutputPortReg,
 /***************************************************************************
 *  Function:		WriteLcd(BYTE dataToWrite, RegType regType)
 *  Description:		Writes the given byte to the instruction register.
+				Waits for the busy flag to clear before writing.
 *  Receives:		BYTE dataToWrite			:	Byte to write.
 				RegType regType			:	Type of register to write to.
 *  Returns:		Nothing
@@ -212,25 +337,42 @@ void WriteLcd(BYTE dataToWrite, RegType regType)
 		/* If setup is completed, then wait if the LCD is still busy */
 		while(lcd.setupCompleted == TRUE && IsBusy());
 		
+		WriteLcdNoWait(dataToWrite, regType);
+	}
+}
+
+/***************************************************************************
+*  Function:		WriteLcdNoWait(BYTE dataToWrite, RegType regType)
+*  Description:		Writes the given byte to the given register without checking the busy flag.
+				The caller is responsible for making sure the LCD is ready, this is one bus
+				transaction of about 3 us.
+*  Receives:		BYTE dataToWrite			:	Byte to write.
+				RegType regType			:	Type of register to write to.
+*  Returns:		Nothing
+***************************************************************************/
+void WriteLcdNoWait(BYTE dataToWrite, RegType regType)
+{
+	if(lcd.initialized)
+	{
 		/* Set the port as output */
 		*lcd.dataDirRegister = 0b11111111;
 		
 		/* Determine register to write to */
 		if(regType == INSTRUCTION_REGISTER)
 		{
-			CLEAR_BIT(lcd.rs.outputPort, lcd.rs.inputPort, lcd.rs.pin);
+			CLEAR_MASK(lcd.controlPortRegister, lcd.rsMask);
 		}
 		else
 		{
-			SET_BIT(lcd.rs.outputPort, lcd.rs.inputPort, lcd.rs.pin);			
+			SET_MASK(lcd.controlPortRegister, lcd.rsMask);			
 		}
 		
 		/* Set to write */
-		CLEAR_BIT(lcd.rw.outputPort, lcd.rw.inputPort, lcd.rw.pin);
+		CLEAR_MASK(lcd.controlPortRegister, lcd.rwMask);
 		
 		/* Wait at least 40 ns (Address Setup Time tsp1) */
 		_delay_us(1);
-		SET_BIT(lcd.enable.outputPort, lcd.enable.inputPort, lcd.enable.pin);
+		SET_MASK(lcd.controlPortRegister, lcd.enableMask);
 		
 		/* Set data to write */
 		*lcd.dataOutputPortRegister = dataToWrite;
@@ -239,16 +381,154 @@ void WriteLcd(BYTE dataToWrite, RegType regType)
 		_delay_us(1);
 		
 		/* Disable LCD */
-		CLEAR_BIT(lcd.enable.outputPort, lcd.enable.inputPort, lcd.enable.pin);
+		CLEAR_MASK(lcd.controlPortRegister, lcd.enableMask);
 		
 		/* Wait at least 10 ns (Address Hold Time thd) */
 		_delay_us(1);
 		
 		/* Reset to reading */
-		SET_BIT(lcd.rw.outputPort, lcd.rw.inputPort, lcd.rw.pin);
+		SET_MASK(lcd.controlPortRegister, lcd.rwMask);
+		
+		/* Keep the address counter and shadow up-to-date */
+		if(regType == INSTRUCTION_REGISTER)
+		{
+			TrackInstruction(dataToWrite);
+		}
+		else
+		{
+			/* CGRAM content is not shadowed, on a one-line display only line 1 is visible */
+			if(lcd.cgramSelected == FALSE && (lcd.address & 0x3F) < LINE_LENGTH &&
+			   ((lcd.functionSet & TWO_LINES_BIT) || lcd.address < LINE_LENGTH))
+				lcd.shadow[(lcd.address >> 6) & 0x01][lcd.address & 0x3F] = dataToWrite;
+			
+			AdvanceAddress();
+		}
+	}
+}
+
+/***************************************************************************
+*  Function:		TrackInstruction(BYTE instruction)
+*  Description:		Updates the address counter copy, entry mode and shadow for the written instruction.
+				A Function Set instruction ends the setup-phase, afterwards the BusyFlag can be polled.
+*  Receives:		BYTE instruction			:	Instruction that was written.
+*  Returns:		Nothing
+***************************************************************************/
+static void TrackInstruction(BYTE instruction)
+{
+	if(instruction & 0b10000000)
+	{
+		/* Set DDRAM address */
+		lcd.address = instruction & 0b01111111;
+		lcd.cgramSelected = FALSE;
+	}
+	else if(instruction & 0b01000000)
+	{
+		/* Set CGRAM address */
+		lcd.address = instruction & 0b00111111;
+		lcd.cgramSelected = TRUE;
+	}
+	else if((instruction & FUNCTION_SET_MASK) == FUNCTION_SET)
+	{
+		lcd.functionSet = instruction;
+		lcd.setupCompleted = TRUE;
+	}
+	else if(instruction & 0b00010000)
+	{
+		/* A cursor shift moves the address counter, a display shift does not */
+		if((instruction & 0b00001000) == 0)
+		{
+			BOOL decrement = lcd.decrement;
+			lcd.decrement = (instruction & 0b00000100) ? FALSE : TRUE;
+			AdvanceAddress();
+			lcd.decrement = decrement;
+		}
+	}
+	else if(instruction & 0b00001000)
+	{
+		/* Display on/off control does not change the address counter */
+		lcd.displayControl = instruction;
+	}
+	else if(instruction & 0b00000100)
+	{
+		/* Entry mode set, bit 1 is set for increment */
+		lcd.entryMode = instruction;
+		lcd.decrement = (instruction & 0b00000010) ? FALSE : TRUE;
+	}
+	else if(instruction & 0b00000010)
+	{
+		/* Return home */
+		lcd.address = 0;
+		lcd.cgramSelected = FALSE;
+	}
+	else if(instruction & 0b00000001)
+	{
+		/* Clear display, this also sets the entry mode to increment (the shift bit is kept) */
+		memset(lcd.shadow, CLEAR_CHAR, sizeof(lcd.shadow));
+		lcd.address = 0;
+		lcd.cgramSelected = FALSE;
+		lcd.decrement = FALSE;
+		lcd.entryMode |= ENTRY_MODE_INCREMENT;
+		
+#if LCD_FEATURE_COALESCING
+		/* Characters still waiting for the next frame would write the old content back */
+		DiscardPendingCharacters();
+#endif
 	}
 }
 
+/***************************************************************************
+*  Function:		AdvanceAddress()
+*  Description:		Increments or decrements the address counter copy like the LCD does after a
+				data access. On a two-line display line 1 wraps to line 2, on a one-line display
+				(or before Function Set) the DDRAM address runs from 0x00 to 0x4F.
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+static void AdvanceAddress(void)
+{
+	if(lcd.cgramSelected == TRUE)
+	{
+		lcd.address = (lcd.decrement ? lcd.address - 1 : lcd.address + 1) & 0b00111111;
+	}
+	else if((lcd.functionSet & TWO_LINES_BIT) == 0)
+	{
+		if(lcd.decrement == FALSE)
+			lcd.address = (lcd.address == ONE_LINE_END_ADDRESS) ? 0 : lcd.address + 1;
+		else
+			lcd.address = (lcd.address == 0) ? ONE_LINE_END_ADDRESS : lcd.address - 1;
+	}
+	else if(lcd.decrement == FALSE)
+	{
+		if(lcd.address == LINE1_END_ADDRESS)
+			lcd.address = LINE2_START_ADDRESS;
+		else if(lcd.address == LINE2_END_ADDRESS)
+			lcd.address = 0;
+		else
+			lcd.address++;
+	}
+	else
+	{
+		if(lcd.address == 0)
+			lcd.address = LINE2_END_ADDRESS;
+		else if(lcd.address == LINE2_START_ADDRESS)
+			lcd.address = LINE1_END_ADDRESS;
+		else
+			lcd.address--;
+	}
+}
+
+/***************************************************************************
+*  Function:		WaitWhileBusy()
+*  Description:		Polls the busy flag until it is cleared, when the setup-phase is not yet
+				completed the busy flag cannot be used and the function returns directly.
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+void WaitWhileBusy(void)
+{
+	while(lcd.setupCompleted == TRUE && ReadBusyFlag());
+}
+
 /***************************************************************************
 *  Function:		WriteInstructionReg(BYTE dataToWrite)
 *  Description:		Writes the given byte to the instruction register.
@@ -290,19 +570,19 @@ BYTE ReadLcd(RegType regType)
 		/* Determine register to read from */
 		if(regType == INSTRUCTION_REGISTER)
 		{
-			CLEAR_BIT(lcd.rs.outputPort, lcd.rs.inputPort, lcd.rs.pin);
+			CLEAR_MASK(lcd.controlPortRegister, lcd.rsMask);
 		}
 		else
 		{
-			SET_BIT(lcd.rs.outputPort, lcd.rs.inputPort, lcd.rs.pin);
+			SET_MASK(lcd.controlPortRegister, lcd.rsMask);
 		}
 	
 		/* Set to read */
-		SET_BIT(lcd.rw.outputPort, lcd.rw.inputPort, lcd.rw.pin);
+		SET_MASK(lcd.controlPortRegister, lcd.rwMask);
 	
 		/* Wait at least 40 ns (Address Setup Time tsp1) */
 		_delay_us(1);
-		SET_BIT(lcd.enable.outputPort, lcd.enable.inputPort, lcd.enable.pin);
+		SET_MASK(lcd.controlPortRegister, lcd.enableMask);
 	
 		/* Wait at least 150 ns (Data output delay time td) */
 		_delay_us(1);
@@ -311,11 +591,14 @@ BYTE ReadLcd(RegType regType)
 		dataRead = *lcd.dataInputPortRegister;
 		
 		/* Disable LCD */
-		CLEAR_BIT(lcd.enable.outputPort, lcd.enable.inputPort, lcd.enable.pin);
+		CLEAR_MASK(lcd.controlPortRegister, lcd.enableMask);
 	
 		/* Wait at least 10 ns (Address Hold Time thd) */
 		_delay_us(1);
-	
+		
+		/* Reading data moves the address counter, same as writing */
+		if(regType == DATA_REGISTER)
+			AdvanceAddress();
 	}
 	return dataRead;
 }
@@ -343,10 +626,162 @@ BYTE ReadDataReg(BYTE address)
 	/* First set the DDRAM address to read from */
 	SetDisplayDataAddress(address);
 	
+	/* Wait until the address is set */
+	WaitWhileBusy();
+	
 	/* Read from the address and return the byte thats read */
 	return ReadLcd(DATA_REGISTER);
 }
 
+/***************************************************************************
+*  Function:		ReadDisplayData(BYTE address, BYTE* buffer, BYTE length)
+*  Description:		Reads length bytes of DDRAM starting at the given address. The address is set
+				once and the auto-increment of the address counter is used for the next bytes,
+				so this takes one instruction plus one read per byte.
+				The entry mode needs to be set to INCREMENT.
+*  Receives:		BYTE address		:	DDRAM address to start reading from.
+				BYTE* buffer		:	Buffer to store the read bytes in.
+				BYTE length		:	Number of bytes to read.
+*  Returns:		Nothing
+***************************************************************************/
+void ReadDisplayData(BYTE address, BYTE* buffer, BYTE length)
+{
+	SetDisplayDataAddress(address);
+	
+	for(BYTE i = 0; i < length; i++)
+	{
+		/* The address counter is updated after each access, wait until it is done */
+		WaitWhileBusy();
+		buffer[i] = ReadLcd(DATA_REGISTER);
+	}
+}
+
+/***************************************************************************
+*  Function:		ReadDisplayLine(BYTE line, BYTE* buffer)
+*  Description:		Reads the 16 visible characters of the given line, nothing is read when
+				the line is not LINE1 or LINE2.
+*  Receives:		BYTE line			:	The line to read.
+				BYTE* buffer		:	Buffer of at least 16 bytes to store the characters in.
+*  Returns:		Nothing
+***************************************************************************/
+void ReadDisplayLine(BYTE line, BYTE* buffer)
+{
+	if(line < LINE1 || line > LINE2)
+		return;
+	
+	/* Line 1 starts at address 0x00 and line 2 at 0x40 */
+	ReadDisplayData((line-1) << 6, buffer, LINE_LENGTH);
+}
+
+/***************************************************************************
+*  Function:		ReadCharacterGenerator(BYTE address, BYTE* buffer, BYTE length)
+*  Description:		Reads length bytes of CGRAM starting at the given address, using the
+				auto-increment of the address counter. Character n starts at address n * 8.
+*  Receives:		BYTE address		:	CGRAM address to start reading from.
+				BYTE* buffer		:	Buffer to store the read bytes in.
+				BYTE length		:	Number of bytes to read.
+*  Returns:		Nothing
+***************************************************************************/
+void ReadCharacterGenerator(BYTE address, BYTE* buffer, BYTE length)
+{
+	SetCharacterGeneratorAddress(address);
+	
+	for(BYTE i = 0; i < length; i++)
+	{
+		WaitWhileBusy();
+		buffer[i] = ReadLcd(DATA_REGISTER);
+	}
+}
+
+/***************************************************************************
+*  Function:		GetShadowCharacter(BYTE line, BYTE pos)
+*  Description:		Returns the character the driver has written to the given line and position,
+				this does not access the LCD.
+*  Receives:		BYTE line			:	The line (LINE1 or LINE2).
+				BYTE pos			:	The position on the line (zero-based)
+*  Returns:		The character, or CLEAR_CHAR when the position is out of range.
+***************************************************************************/
+BYTE GetShadowCharacter(BYTE line, BYTE pos)
+{
+	if(line < LINE1 || line > LINE2 || pos >= LINE_LENGTH)
+		return CLEAR_CHAR;
+	
+	return lcd.shadow[line-1][pos];
+}
+
+/***************************************************************************
+*  Function:		GetShadowAddress()
+*  Description:		Returns the address the driver expects in the address counter of the LCD,
+				this does not access the LCD.
+*  Receives:		Nothing
+*  Returns:		The expected address counter value.
+***************************************************************************/
+BYTE GetShadowAddress(void)
+{
+	return lcd.address;
+}
+
+/***************************************************************************
+*  Function:		GetShadowAddressInstruction()
+*  Description:		Returns the Set DDRAM or Set CGRAM address instruction that puts the address
+				counter at the address the driver expects, this does not access the LCD.
+*  Receives:		Nothing
+*  Returns:		The address instruction.
+***************************************************************************/
+BYTE GetShadowAddressInstruction(void)
+{
+	return ((lcd.cgramSelected == TRUE) ? 0b01000000 : 0b10000000) | lcd.address;
+}
+
+/***************************************************************************
+*  Function:		RestoreDisplay()
+*  Description:		Rewrites the last used configuration and the shadow content to the LCD,
+				used to recover after the LCD has reset itself. The address counter is
+				put back to the value it had before. CGRAM content is not restored.
+				Characters pending for the next frame are sent first, so the restored
+				content is the newest.
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+void RestoreDisplay(void)
+{
+	/* Only restore what has been configured before */
+	if(lcd.setupCompleted == FALSE)
+		return;
+	
+#if LCD_FEATURE_COALESCING
+	FlushFrame();
+#endif
+	
+	BYTE address = lcd.address;
+	BOOL cgramSelected = lcd.cgramSelected;
+	BYTE entryMode = lcd.entryMode;
+	
+	WriteInstructionReg(lcd.functionSet);
+	if(lcd.displayControl != 0)
+		WriteInstructionReg(lcd.displayControl);
+	
+	/* Rewrite the content of both lines, always incrementing */
+	SetEntryMode(INCREMENT, FALSE);
+	for(BYTE line = 0; line < 2; line++)
+	{
+		SetDisplayDataAddress(line << 6);
+		for(BYTE pos = 0; pos < LINE_LENGTH; pos++)
+		{
+			WriteDataReg(lcd.shadow[line][pos]);
+		}
+	}
+	
+	/* Restore entry mode and address counter */
+	if(entryMode != 0)
+		WriteInstructionReg(entryMode);
+	
+	if(cgramSelected == TRUE)
+		SetCharacterGeneratorAddress(address);
+	else
+		SetDisplayDataAddress(address);
+}
+
 
 /***************************************************************************
 *  Function:		ClearDisplay()
@@ -459,10 +894,8 @@ void FunctionSet(DataLength length, Lines lines, Font font)
 	if(lines != TWO_LINES && font == FONT5x10)
 		dataToWrite |= 0b00000100;
 		
+	/* Setup is set to complete by WriteLcdNoWait, after this function we can use the BusyFlag */
 	WriteInstructionReg(dataToWrite);
-	
-	/* Set setup to complete, after this function we can use the BusyFlag */
-	lcd.setupCompleted = TRUE;
 }
 
 /***************************************************************************
@@ -539,3 +972,27 @@ BOOL IsBusy(void)
 	return isBusy;
 }
 
+/***************************************************************************
+*  Function:		ReadBusyFlag()
+*  Description:		Reads the busy flag once, without the delay IsBusy adds afterwards.
+				This is a single bus transaction of about 3 us, so it can be used for polling.
+*  Receives:		Nothing
+*  Returns:		Boolean indicating the state of the busy flag (True == Busy).
+***************************************************************************/
+BOOL ReadBusyFlag(void)
+{
+	/* Bit 7 of the instruction register is the busy flag */
+	return (ReadInstructionReg() & 0x80) ? TRUE : FALSE;
+}
+
+/***************************************************************************
+*  Function:		IsSetupCompleted()
+*  Description:		Returns if the setup-phase is completed (a Function Set instruction was written),
+				only then the busy flag can be polled.
+*  Receives:		Nothing
+*  Returns:		Boolean indicating if the setup-phase is completed.
+***************************************************************************/
+BOOL IsSetupCompleted(void)
+{
+	return lcd.setupCompleted;
+}
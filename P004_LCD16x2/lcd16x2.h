@@ -20,12 +20,14 @@
 
 
 #include "common.h"
+#include "lcd16x2_config.h"
 
 /************************************************************************/
 /* Defines				                                                                  */
 /************************************************************************/
 #define LINE1			1
 #define LINE2			2
+#define LINE_LENGTH		16
 
 /************************************************************************/
 /* Type Definitions			                                                                  */
@@ -51,6 +53,8 @@ void InitializeLcd(volatile BYTE* dataOutputPortReg,
 
 void WriteNewLine(char* string, BYTE line);
 void ClearCharacter(BYTE line, BYTE pos);
+void UpdateCharacter(BYTE line, BYTE pos, BYTE character);
+BYTE WriteCharacter(BYTE line, BYTE pos, BYTE character);
 void WriteToPosition(char* string, BYTE line, BYTE pos, BYTE positionsToClear);
 
 /************************************************************************/
@@ -67,6 +71,10 @@ void SetCharacterGeneratorAddress(BYTE address);
 void SetDisplayDataAddress(BYTE address);
 BYTE ReadAddressCounter(void);
 BOOL IsBusy(void);
+BOOL ReadBusyFlag(void);
+BOOL IsSetupCompleted(void);
+void WaitWhileBusy(void);
+void RestoreDisplay(void);
 
 
 /************************************************************************/
@@ -76,9 +84,17 @@ BOOL IsBusy(void);
 void WriteDataReg(BYTE dataToWrite);
 void WriteInstructionReg(BYTE dataToWrite);
 void WriteLcd(BYTE dataToWrite, RegType regType);
+void WriteLcdNoWait(BYTE dataToWrite, RegType regType);
 
 BYTE ReadInstructionReg(void);
 BYTE ReadDataReg(BYTE address);
 BYTE ReadLcd(RegType regType);
 
+void ReadDisplayData(BYTE address, BYTE* buffer, BYTE length);
+void ReadDisplayLine(BYTE line, BYTE* buffer);
+void ReadCharacterGenerator(BYTE address, BYTE* buffer, BYTE length);
+BYTE GetShadowCharacter(BYTE line, BYTE pos);
+BYTE GetShadowAddress(void);
+BYTE GetShadowAddressInstruction(void);
+
 #endif /* LCD16X2_H_ */
\ No newline at end of file
@@ -0,0 +1,122 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project:		Library for LCD 16x2
+ * Hardware:		LCD Display 16x2 type YM1602C
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_capture.c
+ * Purpose: 		LCD 16x2 screen capture and readback verification
+ * Date:			18-10-2026
+ * Version:		1.0
+ * Author:		Marcel van der Ven
+ *
+ * Release notes:	Oct. 18, 2026:	1.0 - Initial Release
+ *
+ * Note(s):		Reading moves the address counter (and the cursor when it is on), the next write
+ *				should set its own address, as WriteToPosition does.
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+/************************************************************************/
+/* Includes				                                                                  */
+/************************************************************************/
+#include "lcd16x2_capture.h"
+
+
+/************************************************************************/
+/* Local Function Prototypes		                                                                  */
+/************************************************************************/
+static BYTE FinishFrame(BYTE* frame, BYTE type, BYTE payloadLength);
+
+
+/************************************************************************/
+/* Functions				                                                                  */
+/************************************************************************/
+
+/***************************************************************************
+*  Function:		CaptureScreen(BYTE* frame)
+*  Description:		Reads the visible content of both lines into a capture frame.
+				This takes two address instructions and 32 reads.
+*  Receives:		BYTE* frame		:	Buffer of at least CAPTURE_SCREEN_LENGTH bytes.
+*  Returns:		Length of the frame in bytes.
+***************************************************************************/
+BYTE CaptureScreen(BYTE* frame)
+{
+	ReadDisplayLine(LINE1, &frame[CAPTURE_HEADER_LENGTH]);
+	ReadDisplayLine(LINE2, &frame[CAPTURE_HEADER_LENGTH + LINE_LENGTH]);
+
+	return FinishFrame(frame, CAPTURE_SCREEN, 2 * LINE_LENGTH);
+}
+
+/***************************************************************************
+*  Function:		CaptureCharacterGenerator(BYTE* frame)
+*  Description:		Reads the complete CGRAM (8 characters of 8 rows) into a capture frame.
+*  Receives:		BYTE* frame		:	Buffer of at least CAPTURE_CGRAM_LENGTH bytes.
+*  Returns:		Length of the frame in bytes.
+***************************************************************************/
+BYTE CaptureCharacterGenerator(BYTE* frame)
+{
+	ReadCharacterGenerator(0, &frame[CAPTURE_HEADER_LENGTH], 64);
+
+	return FinishFrame(frame, CAPTURE_CGRAM, 64);
+}
+
+/***************************************************************************
+*  Function:		VerifyLine(BYTE line)
+*  Description:		Reads back the given line and compares it with what the driver has written.
+*  Receives:		BYTE line			:	The line to verify.
+*  Returns:		Number of characters that differ, 0 for an invalid line.
+***************************************************************************/
+BYTE VerifyLine(BYTE line)
+{
+	BYTE buffer[LINE_LENGTH];
+	BYTE mismatches = 0;
+
+	if(line < LINE1 || line > LINE2)
+		return 0;
+
+	ReadDisplayLine(line, buffer);
+
+	for(BYTE pos = 0; pos < LINE_LENGTH; pos++)
+	{
+		if(buffer[pos] != GetShadowCharacter(line, pos))
+			mismatches++;
+	}
+
+	return mismatches;
+}
+
+/***************************************************************************
+*  Function:		VerifyScreen()
+*  Description:		Reads back both lines and compares them with what the driver has written.
+*  Receives:		Nothing
+*  Returns:		Number of characters that differ.
+***************************************************************************/
+BYTE VerifyScreen(void)
+{
+	return VerifyLine(LINE1) + VerifyLine(LINE2);
+}
+
+/***************************************************************************
+*  Function:		FinishFrame(BYTE* frame, BYTE type, BYTE payloadLength)
+*  Description:		Fills in the header and checksum around the payload already in the frame.
+*  Receives:		BYTE* frame		:	The frame, payload starts at CAPTURE_HEADER_LENGTH.
+				BYTE type			:	Frame type.
+				BYTE payloadLength	:	Number of payload bytes.
+*  Returns:		Length of the frame in bytes.
+***************************************************************************/
+static BYTE FinishFrame(BYTE* frame, BYTE type, BYTE payloadLength)
+{
+	BYTE checksum = 0;
+
+	frame[0] = CAPTURE_MARKER;
+	frame[1] = type;
+	frame[2] = payloadLength;
+
+	for(BYTE i = 0; i < payloadLength; i++)
+	{
+		checksum += frame[CAPTURE_HEADER_LENGTH + i];
+	}
+	frame[CAPTURE_HEADER_LENGTH + payloadLength] = checksum;
+
+	return CAPTURE_HEADER_LENGTH + payloadLength + 1;
+}
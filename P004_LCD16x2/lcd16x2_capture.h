@@ -0,0 +1,51 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project: 		LCD 16x2 Library
+ * Hardware:		Arduino UNO
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_capture.h
+ * Purpose: 		LCD 16x2 screen capture and readback verification header
+ * Date:			18-10-2026
+ * Author:		Marcel van der Ven
+ *
+ * Hardware setup:
+ *
+ * Note(s):		Capture frame layout (all bytes binary, can be sent as-is over the UART):
+ *
+ *				Byte 0			:	CAPTURE_MARKER
+ *				Byte 1			:	Frame type, CAPTURE_SCREEN or CAPTURE_CGRAM
+ *				Byte 2			:	Payload length n
+ *				Byte 3 .. n+2		:	Payload, screen is line 1 followed by line 2
+ *				Byte n+3			:	Checksum, 8-bit sum of the payload
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+
+#ifndef LCD16X2_CAPTURE_H_
+#define LCD16X2_CAPTURE_H_
+
+
+#include "common.h"
+#include "lcd16x2.h"
+
+/************************************************************************/
+/* Defines				                                                                  */
+/************************************************************************/
+#define CAPTURE_MARKER			0xA5
+#define CAPTURE_SCREEN			'S'
+#define CAPTURE_CGRAM			'G'
+
+#define CAPTURE_HEADER_LENGTH		3
+#define CAPTURE_SCREEN_LENGTH		(CAPTURE_HEADER_LENGTH + 2 * LINE_LENGTH + 1)
+#define CAPTURE_CGRAM_LENGTH		(CAPTURE_HEADER_LENGTH + 64 + 1)
+
+/************************************************************************/
+/* API					                                                                  */
+/************************************************************************/
+BYTE CaptureScreen(BYTE* frame);
+BYTE CaptureCharacterGenerator(BYTE* frame);
+
+BYTE VerifyLine(BYTE line);
+BYTE VerifyScreen(void);
+
+#endif /* LCD16X2_CAPTURE_H_ */
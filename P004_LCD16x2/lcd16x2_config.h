@@ -0,0 +1,56 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project: 		LCD 16x2 Library
+ * Hardware:		Arduino UNO
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_config.h
+ * Purpose: 		LCD 16x2 Library build configuration
+ * Date:			18-10-2026
+ * Author:		Marcel van der Ven
+ *
+ * Hardware setup:
+ *
+ * Note(s):		Optional features that need hooks in the core driver and settings of the optional
+ *				modules. Set a feature to 0 to leave its code out of the build, the defines can
+ *				also be given on the compiler command line.
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+
+#ifndef LCD16X2_CONFIG_H_
+#define LCD16X2_CONFIG_H_
+
+/************************************************************************/
+/* Features				                                                                  */
+/************************************************************************/
+/* Frame-rate limited coalescing of WriteToPosition and ClearCharacter (lcd16x2_frame.c) */
+#ifndef LCD_FEATURE_COALESCING
+#define LCD_FEATURE_COALESCING		1
+#endif
+
+/************************************************************************/
+/* Character ROM				                                                                  */
+/************************************************************************/
+#define LCD_ROM_A00			0
+#define LCD_ROM_A02			2
+
+/* Character ROM of the display, the YM1602C uses A00 (Japanese), A02 is the European variant */
+#ifndef LCD_CHARACTER_ROM
+#define LCD_CHARACTER_ROM		LCD_ROM_A00
+#endif
+
+/* CGRAM characters the UTF-8 translation may use for characters that are not in the ROM. */
+/* The graphics engine (lcd16x2_graphics.c) uses CGRAM characters 0 - 7, so by default the */
+/* translation uses none. Without the graphics engine set the first to 0 and the count to 8. */
+#ifndef LCD_UTF8_CGRAM_FIRST
+#define LCD_UTF8_CGRAM_FIRST		0
+#endif
+#ifndef LCD_UTF8_CGRAM_COUNT
+#define LCD_UTF8_CGRAM_COUNT		0
+#endif
+
+#if (LCD_UTF8_CGRAM_FIRST + LCD_UTF8_CGRAM_COUNT) > 8
+#error "The UTF-8 CGRAM characters must be within CGRAM characters 0 - 7"
+#endif
+
+#endif /* LCD16X2_CONFIG_H_ */
@@ -0,0 +1,211 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project:		Library for LCD 16x2
+ * Hardware:		LCD Display 16x2 type YM1602C
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_frame.c
+ * Purpose: 		LCD 16x2 frame-rate limited update coalescing
+ * Date:			18-10-2026
+ * Version:		1.0
+ * Author:		Marcel van der Ven
+ *
+ * Release notes:	Oct. 18, 2026:	1.0 - Initial Release
+ *
+ * Note(s):		The liquid crystal needs about 200 ms to follow a change, updating faster than
+ *				10 - 30 frames per second only costs bus time. A pending character is compared with
+ *				the shadow when the frame is sent, so a value that returns to what is displayed
+ *				costs no write at all.
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+/************************************************************************/
+/* Includes				                                                                  */
+/************************************************************************/
+#include "lcd16x2_frame.h"
+#include "string.h"
+
+#if LCD_FEATURE_COALESCING
+
+/************************************************************************/
+/* Structures				                                                                  */
+/************************************************************************/
+static struct Frame
+{
+	/* Time between two frames in ms, 0 when coalescing is disabled */
+	uint16_t framePeriod;
+	uint16_t lastFrameTime;
+
+	/* Newest submitted character per position, only valid when its pending bit is set */
+	BYTE characters[2][LINE_LENGTH];
+
+	/* Characters that need to be sent, bit n is position n */
+	uint16_t pending[2];
+
+	struct FrameStatistics statistics;
+} frame;
+
+
+/************************************************************************/
+/* Functions				                                                                  */
+/************************************************************************/
+
+/***************************************************************************
+*  Function:		EnableCoalescing(BYTE framesPerSecond)
+*  Description:		Enables coalescing with the given refresh rate, or disables it when the rate is 0.
+				Pending characters are sent before coalescing is disabled.
+*  Receives:		BYTE framesPerSecond	:	Number of frames per second, typically 10 - 30.
+*  Returns:		Nothing
+***************************************************************************/
+void EnableCoalescing(BYTE framesPerSecond)
+{
+	if(framesPerSecond == 0)
+	{
+		FlushFrame();
+		frame.framePeriod = 0;
+	}
+	else
+	{
+		frame.framePeriod = 1000 / framesPerSecond;
+	}
+}
+
+/***************************************************************************
+*  Function:		IsCoalescingEnabled()
+*  Description:		Returns if writes are coalesced.
+*  Receives:		Nothing
+*  Returns:		TRUE when coalescing is enabled.
+***************************************************************************/
+BOOL IsCoalescingEnabled(void)
+{
+	return (frame.framePeriod != 0) ? TRUE : FALSE;
+}
+
+/***************************************************************************
+*  Function:		SubmitCharacter(BYTE line, BYTE pos, BYTE character)
+*  Description:		Marks the character at the given line and position to be sent with the next frame,
+				a value still pending for that position is dropped.
+*  Receives:		BYTE line			:	The line to write to.
+				BYTE pos			:	The position on the line (zero-based)
+				BYTE character		:	The character to write.
+*  Returns:		Nothing
+***************************************************************************/
+void SubmitCharacter(BYTE line, BYTE pos, BYTE character)
+{
+	if(line < LINE1 || line > LINE2 || pos >= LINE_LENGTH)
+		return;
+
+	uint16_t mask = (uint16_t)1 << pos;
+
+	frame.statistics.submittedUpdates++;
+	if(frame.pending[line-1] & mask)
+		frame.statistics.coalescedUpdates++;
+
+	frame.characters[line-1][pos] = character;
+	frame.pending[line-1] |= mask;
+}
+
+/***************************************************************************
+*  Function:		FrameTask(uint16_t timeMs)
+*  Description:		Sends the pending characters when a frame period has passed, needs to be called
+				periodically from the main loop.
+*  Receives:		uint16_t timeMs		:	Free running time in ms, overflow is allowed.
+*  Returns:		Nothing
+***************************************************************************/
+void FrameTask(uint16_t timeMs)
+{
+	if(frame.framePeriod == 0)
+		return;
+
+	/* Unsigned subtraction also works when the time overflows */
+	if((uint16_t)(timeMs - frame.lastFrameTime) < frame.framePeriod)
+		return;
+
+	frame.lastFrameTime = timeMs;
+	FlushFrame();
+}
+
+/***************************************************************************
+*  Function:		FlushFrame()
+*  Description:		Sends all pending characters that differ from the displayed content. Adjacent
+				characters share one address instruction (see WriteCharacter).
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+void FlushFrame(void)
+{
+	BOOL written = FALSE;
+
+	for(BYTE line = LINE1; line <= LINE2; line++)
+	{
+		for(BYTE pos = 0; pos < LINE_LENGTH && frame.pending[line-1] != 0; pos++)
+		{
+			uint16_t mask = (uint16_t)1 << pos;
+
+			if((frame.pending[line-1] & mask) == 0)
+				continue;
+
+			frame.pending[line-1] &= ~mask;
+
+			/* Nothing to send when the LCD already shows the character */
+			if(frame.characters[line-1][pos] == GetShadowCharacter(line, pos))
+			{
+				frame.statistics.coalescedUpdates++;
+				continue;
+			}
+
+			WriteCharacter(line, pos, frame.characters[line-1][pos]);
+			written = TRUE;
+		}
+	}
+
+	if(written == TRUE)
+		frame.statistics.frames++;
+}
+
+/***************************************************************************
+*  Function:		DiscardPendingCharacters()
+*  Description:		Drops all pending characters, called by the driver when the display is cleared.
+				The dropped characters are counted as coalesced.
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+void DiscardPendingCharacters(void)
+{
+	/* Runs inside WriteLcdNoWait, so count the pending bits without shifting a mask per position */
+	for(BYTE line = 0; line < 2; line++)
+	{
+		uint16_t pending = frame.pending[line];
+
+		while(pending != 0)
+		{
+			/* Clears the lowest set bit */
+			pending &= pending - 1;
+			frame.statistics.coalescedUpdates++;
+		}
+		frame.pending[line] = 0;
+	}
+}
+
+/***************************************************************************
+*  Function:		GetFrameStatistics(struct FrameStatistics* statistics)
+*  Description:		Copies the coalescing counters.
+*  Receives:		struct FrameStatistics* statistics	:	Structure to copy the counters to.
+*  Returns:		Nothing
+***************************************************************************/
+void GetFrameStatistics(struct FrameStatistics* statistics)
+{
+	*statistics = frame.statistics;
+}
+
+/***************************************************************************
+*  Function:		ResetFrameStatistics()
+*  Description:		Clears the coalescing counters.
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+void ResetFrameStatistics(void)
+{
+	memset(&frame.statistics, 0, sizeof(frame.statistics));
+}
+
+#endif /* LCD_FEATURE_COALESCING */
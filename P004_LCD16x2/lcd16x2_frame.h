@@ -0,0 +1,57 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project: 		LCD 16x2 Library
+ * Hardware:		Arduino UNO
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_frame.h
+ * Purpose: 		LCD 16x2 frame-rate limited update coalescing header
+ * Date:			18-10-2026
+ * Author:		Marcel van der Ven
+ *
+ * Hardware setup:
+ *
+ * Note(s):		While coalescing is enabled WriteToPosition, WriteNewLine and ClearCharacter only mark
+ *				the characters as pending. FrameTask() sends the newest value of every pending character
+ *				once per frame, intermediate values are never sent to the LCD. A Clear Display drops
+ *				the pending characters.
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+
+#ifndef LCD16X2_FRAME_H_
+#define LCD16X2_FRAME_H_
+
+
+#include "common.h"
+#include "lcd16x2.h"
+
+/************************************************************************/
+/* Structures				                                                                  */
+/************************************************************************/
+struct FrameStatistics
+{
+	/* Number of characters submitted while coalescing */
+	uint16_t submittedUpdates;
+
+	/* Number of submitted characters that did not need a write (overwritten or unchanged) */
+	uint16_t coalescedUpdates;
+
+	/* Number of frames in which at least one character was written */
+	uint16_t frames;
+};
+
+/************************************************************************/
+/* API					                                                                  */
+/************************************************************************/
+void EnableCoalescing(BYTE framesPerSecond);
+BOOL IsCoalescingEnabled(void);
+
+void SubmitCharacter(BYTE line, BYTE pos, BYTE character);
+void FrameTask(uint16_t timeMs);
+void FlushFrame(void);
+void DiscardPendingCharacters(void);
+
+void GetFrameStatistics(struct FrameStatistics* statistics);
+void ResetFrameStatistics(void);
+
+#endif /* LCD16X2_FRAME_H_ */
@@ -0,0 +1,210 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project:		Library for LCD 16x2
+ * Hardware:		LCD Display 16x2 type YM1602C
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_graphics.c
+ * Purpose: 		LCD 16x2 big digit and bar graph rendering
+ * Date:			18-10-2026
+ * Version:		1.0
+ * Author:		Marcel van der Ven
+ *
+ * Release notes:	Oct. 18, 2026:	1.0 - Initial Release
+ *
+ * Note(s):		The 8 CGRAM glyphs are shared by all graphics:
+ *				- top bar, bottom bar and top + bottom bar for the big digits, together with the full block
+ *				- lower half block for the vertical bars (2 steps per character)
+ *				- 1 to 4 filled columns for the horizontal bars (5 steps per character)
+ *				Drawing goes through UpdateCharacter, so characters that do not change are not written.
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+/************************************************************************/
+/* Includes				                                                                  */
+/************************************************************************/
+#include <avr/pgmspace.h>
+#include "lcd16x2_graphics.h"
+
+
+/************************************************************************/
+/* Tables				                                                                  */
+/************************************************************************/
+/* Row patterns of the glyphs, in CGRAM order */
+static const BYTE glyphs[8][8] PROGMEM =
+{
+	{ 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	/* GLYPH_TOP */
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F },	/* GLYPH_BOTTOM */
+	{ 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F },	/* GLYPH_TOP_BOTTOM */
+	{ 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F },	/* GLYPH_LOWER_HALF */
+	{ 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 },	/* GLYPH_COLUMNS_1 */
+	{ 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18 },	/* GLYPH_COLUMNS_2 */
+	{ 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C },	/* GLYPH_COLUMNS_3 */
+	{ 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E }	/* GLYPH_COLUMNS_4 */
+};
+
+#define F	GLYPH_FULL
+#define T	GLYPH_TOP
+#define B	GLYPH_BOTTOM
+#define X	GLYPH_TOP_BOTTOM
+#define _	GLYPH_EMPTY
+
+/* Characters of the big digits, line 1 followed by line 2 */
+static const BYTE bigDigits[11][2 * BIG_DIGIT_WIDTH] PROGMEM =
+{
+	{ F, T, F,	F, B, F },	/* 0 */
+	{ T, F, _,	B, F, B },	/* 1 */
+	{ X, X, F,	F, B, B },	/* 2 */
+	{ X, X, F,	B, B, F },	/* 3 */
+	{ F, B, F,	_, _, F },	/* 4 */
+	{ F, X, X,	B, B, F },	/* 5 */
+	{ F, X, X,	F, B, F },	/* 6 */
+	{ T, T, F,	_, _, F },	/* 7 */
+	{ F, X, F,	F, B, F },	/* 8 */
+	{ F, X, F,	B, B, F },	/* 9 */
+	{ _, _, _,	_, _, _ }	/* BIG_DIGIT_BLANK */
+};
+
+#undef F
+#undef T
+#undef B
+#undef X
+#undef _
+
+
+/************************************************************************/
+/* Functions				                                                                  */
+/************************************************************************/
+
+/***************************************************************************
+*  Function:		LoadGraphicsGlyphs()
+*  Description:		Uploads the segment glyphs to CGRAM, this only needs to be done once after the
+				LCD is setup. Characters on the display using the glyphs change directly.
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+void LoadGraphicsGlyphs(void)
+{
+	/* The address counter increments after each write, so one address instruction is enough */
+	SetCharacterGeneratorAddress(0);
+
+	for(BYTE i = 0; i < sizeof(glyphs); i++)
+	{
+		WriteDataReg(pgm_read_byte(&glyphs[0][0] + i));
+	}
+}
+
+/***************************************************************************
+*  Function:		DrawBigDigit(BYTE pos, BYTE digit)
+*  Description:		Draws a big digit over both lines, starting at the given position.
+*  Receives:		BYTE pos			:	Position of the left column of the digit (zero-based)
+				BYTE digit			:	The digit 0 - 9, or BIG_DIGIT_BLANK to clear it.
+*  Returns:		Nothing
+***************************************************************************/
+void DrawBigDigit(BYTE pos, BYTE digit)
+{
+	if(digit > BIG_DIGIT_BLANK)
+		digit = BIG_DIGIT_BLANK;
+
+	/* One line at a time, so adjacent changed characters share one address instruction */
+	for(BYTE line = LINE1; line <= LINE2; line++)
+	{
+		for(BYTE i = 0; i < BIG_DIGIT_WIDTH; i++)
+		{
+			UpdateCharacter(line, pos + i, pgm_read_byte(&bigDigits[digit][(line-1) * BIG_DIGIT_WIDTH + i]));
+		}
+	}
+}
+
+/***************************************************************************
+*  Function:		DrawBigNumber(BYTE pos, uint16_t value, BYTE digits)
+*  Description:		Draws the value right-aligned in the given number of big digits, leading zeros
+				are left blank. Only digits that changed are written.
+*  Receives:		BYTE pos			:	Position of the left column of the number (zero-based)
+				uint16_t value		:	Value to draw, only the lowest digits are shown.
+				BYTE digits			:	Number of digits, at most 4 fit on the display.
+*  Returns:		Nothing
+***************************************************************************/
+void DrawBigNumber(BYTE pos, uint16_t value, BYTE digits)
+{
+	/* Draw from the right-most digit to the left */
+	for(BYTE i = digits; i > 0; i--)
+	{
+		BYTE digit = value % 10;
+
+		/* Keep the last digit when the value is 0 */
+		if(value == 0 && i != digits)
+			digit = BIG_DIGIT_BLANK;
+
+		DrawBigDigit(pos + (i - 1) * BIG_DIGIT_PITCH, digit);
+		value /= 10;
+	}
+}
+
+/***************************************************************************
+*  Function:		DrawHorizontalBar(BYTE line, BYTE pos, BYTE width, BYTE value)
+*  Description:		Draws a horizontal bar from left to right with a resolution of one pixel column.
+*  Receives:		BYTE line			:	The line to draw the bar on.
+				BYTE pos			:	Position of the left character of the bar (zero-based)
+				BYTE width			:	Width of the bar in characters.
+				BYTE value			:	Length of the bar, 0 - width * HORIZONTAL_STEPS_PER_CHAR
+*  Returns:		Nothing
+***************************************************************************/
+void DrawHorizontalBar(BYTE line, BYTE pos, BYTE width, BYTE value)
+{
+	for(BYTE i = 0; i < width; i++)
+	{
+		BYTE character;
+
+		if(value >= HORIZONTAL_STEPS_PER_CHAR)
+		{
+			character = GLYPH_FULL;
+			value -= HORIZONTAL_STEPS_PER_CHAR;
+		}
+		else if(value > 0)
+		{
+			/* Partial character, the glyphs for 1 - 4 columns follow each other */
+			character = GLYPH_COLUMNS_1 + (value - 1);
+			value = 0;
+		}
+		else
+		{
+			character = GLYPH_EMPTY;
+		}
+
+		UpdateCharacter(line, pos + i, character);
+	}
+}
+
+/***************************************************************************
+*  Function:		DrawVerticalBar(BYTE pos, BYTE value)
+*  Description:		Draws a vertical bar over both lines from bottom to top, with a resolution of
+				half a character.
+*  Receives:		BYTE pos			:	Position of the bar (zero-based)
+				BYTE value			:	Height of the bar, 0 - 2 * VERTICAL_STEPS_PER_CHAR
+*  Returns:		Nothing
+***************************************************************************/
+void DrawVerticalBar(BYTE pos, BYTE value)
+{
+	/* Line 2 is the bottom half of the bar */
+	for(BYTE line = LINE2; line >= LINE1; line--)
+	{
+		BYTE character;
+
+		if(value >= VERTICAL_STEPS_PER_CHAR)
+		{
+			character = GLYPH_FULL;
+			value -= VERTICAL_STEPS_PER_CHAR;
+		}
+		else if(value > 0)
+		{
+			character = GLYPH_LOWER_HALF;
+			value = 0;
+		}
+		else
+		{
+			character = GLYPH_EMPTY;
+		}
+
+		UpdateCharacter(line, pos, character);
+	}
+}
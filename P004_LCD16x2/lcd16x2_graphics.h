@@ -0,0 +1,65 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project: 		LCD 16x2 Library
+ * Hardware:		Arduino UNO
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_graphics.h
+ * Purpose: 		LCD 16x2 big digit and bar graph rendering header
+ * Date:			18-10-2026
+ * Author:		Marcel van der Ven
+ *
+ * Hardware setup:
+ *
+ * Note(s):		All graphics share one set of 8 segment glyphs, uploaded to CGRAM once by
+ *				LoadGraphicsGlyphs. Drawing only writes the characters that changed, a bar that
+ *				moves one step costs one or two writes. After the LCD has been reset the glyphs need
+ *				to be loaded again, for example from the restore handler of the scrub.
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+
+#ifndef LCD16X2_GRAPHICS_H_
+#define LCD16X2_GRAPHICS_H_
+
+
+#include "common.h"
+#include "lcd16x2.h"
+
+/************************************************************************/
+/* Defines				                                                                  */
+/************************************************************************/
+/* Segment glyphs in CGRAM */
+#define GLYPH_TOP			0
+#define GLYPH_BOTTOM			1
+#define GLYPH_TOP_BOTTOM		2
+#define GLYPH_LOWER_HALF		3
+#define GLYPH_COLUMNS_1		4
+#define GLYPH_COLUMNS_2		5
+#define GLYPH_COLUMNS_3		6
+#define GLYPH_COLUMNS_4		7
+
+/* Character ROM glyphs */
+#define GLYPH_FULL			0xFF
+#define GLYPH_EMPTY			0x20
+
+/* A big digit is 3 characters wide and uses both lines, the pitch adds one empty column */
+#define BIG_DIGIT_WIDTH		3
+#define BIG_DIGIT_PITCH		4
+#define BIG_DIGIT_BLANK		10
+
+/* Resolution of the bars */
+#define HORIZONTAL_STEPS_PER_CHAR	5
+#define VERTICAL_STEPS_PER_CHAR		2
+
+/************************************************************************/
+/* API					                                                                  */
+/************************************************************************/
+void LoadGraphicsGlyphs(void);
+
+void DrawBigDigit(BYTE pos, BYTE digit);
+void DrawBigNumber(BYTE pos, uint16_t value, BYTE digits);
+
+void DrawHorizontalBar(BYTE line, BYTE pos, BYTE width, BYTE value);
+void DrawVerticalBar(BYTE pos, BYTE value);
+
+#endif /* LCD16X2_GRAPHICS_H_ */
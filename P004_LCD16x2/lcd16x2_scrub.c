@@ -0,0 +1,299 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project:		Library for LCD 16x2
+ * Hardware:		LCD Display 16x2 type YM1602C
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_scrub.c
+ * Purpose: 		LCD 16x2 background DDRAM scrub
+ * Date:			18-10-2026
+ * Version:		1.0
+ * Author:		Marcel van der Ven
+ *
+ * Release notes:	Oct. 18, 2026:	1.0 - Initial Release
+ *
+ * Note(s):		Each call of ScrubTask either checks a slice of one line or rewrites the characters
+ *				found corrupted in the previous call. Every call starts with reading the busy flag and
+ *				address counter, when the LCD is busy the call returns directly. When the address
+ *				counter differs from the shadow address the LCD has lost its state (a reset clears it)
+ *				and the complete display is restored.
+ *
+ *				Nothing in the scrub waits: every access is preceded by a busy flag read, which counts
+ *				against the budget as well, and the scrub stops for this call when the LCD is busy.
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+/************************************************************************/
+/* Defines				                                                                  */
+/************************************************************************/
+/* When at least this many characters of a slice are all wrong the LCD is considered reset */
+#define SCRUB_RESET_THRESHOLD		4
+
+#define SET_DDRAM_ADDRESS	0b10000000
+
+/************************************************************************/
+/* Includes				                                                                  */
+/************************************************************************/
+#include "lcd16x2_scrub.h"
+#include "string.h"
+
+
+/************************************************************************/
+/* Structures				                                                                  */
+/************************************************************************/
+static struct Scrub
+{
+	/* Maximum number of bus transactions per call, busy flag reads included */
+	BYTE transactionsPerTick;
+
+	/* Transactions left in the current call, and if the LCD is known to be ready for the next access */
+	BYTE budget;
+	BOOL ready;
+
+	/* Next character to check, 0 - 15 is line 1 and 16 - 31 is line 2 */
+	BYTE position;
+
+	/* Characters of repairLine that need to be rewritten, bit n is position n */
+	uint16_t repairMask;
+	BYTE repairLine;
+
+	/* Called after the display has been restored, 0 when not used */
+	void (*restoreHandler)(void);
+
+	struct ScrubStatistics statistics;
+} scrub;
+
+
+/************************************************************************/
+/* Local Function Prototypes		                                                                  */
+/************************************************************************/
+static BOOL ClaimAccess(void);
+static void CheckSlice(void);
+static void RepairCells(void);
+static void Recover(void);
+
+
+/************************************************************************/
+/* Functions				                                                                  */
+/************************************************************************/
+
+/***************************************************************************
+*  Function:		InitializeScrub(BYTE transactionsPerTick)
+*  Description:		Initializes the scrub with the given bus budget per call and clears the statistics.
+*  Receives:		BYTE transactionsPerTick	:	Maximum number of bus transactions per call of ScrubTask,
+											at least SCRUB_MINIMUM_BUDGET.
+*  Returns:		Nothing
+***************************************************************************/
+void InitializeScrub(BYTE transactionsPerTick)
+{
+	memset(&scrub, 0, sizeof(scrub));
+
+	if(transactionsPerTick < SCRUB_MINIMUM_BUDGET)
+		transactionsPerTick = SCRUB_MINIMUM_BUDGET;
+
+	scrub.transactionsPerTick = transactionsPerTick;
+}
+
+/***************************************************************************
+*  Function:		SetScrubRestoreHandler(void (*restoreHandler)(void))
+*  Description:		Sets the function that is called after the scrub has restored a reset LCD.
+				RestoreDisplay does not restore CGRAM, the handler can load the glyphs again
+				(LoadGraphicsGlyphs, InvalidateUtf8Glyphs).
+*  Receives:		void (*restoreHandler)(void)	:	Function to call, 0 for none.
+*  Returns:		Nothing
+***************************************************************************/
+void SetScrubRestoreHandler(void (*restoreHandler)(void))
+{
+	scrub.restoreHandler = restoreHandler;
+}
+
+/***************************************************************************
+*  Function:		ScrubTask()
+*  Description:		Verifies the next slice of the display or repairs the corrupted characters of
+				the previous slice. Needs to be called periodically from the main loop.
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+void ScrubTask(void)
+{
+	/* Before the setup-phase is completed there is nothing to verify */
+	if(scrub.transactionsPerTick == 0 || IsSetupCompleted() == FALSE)
+		return;
+
+	/* One read gives the busy flag and the address counter */
+	BYTE status = ReadInstructionReg();
+	scrub.budget = scrub.transactionsPerTick - 1;
+	if(status & 0x80)
+		return;
+
+	/* The address counter is cleared when the LCD resets, compare it with the expected value */
+	if((status & 0x7F) != GetShadowAddress())
+	{
+		Recover();
+		return;
+	}
+	scrub.ready = TRUE;
+
+	if(scrub.repairMask != 0)
+		RepairCells();
+	else
+		CheckSlice();
+}
+
+/***************************************************************************
+*  Function:		GetScrubStatistics(struct ScrubStatistics* statistics)
+*  Description:		Copies the scrub counters.
+*  Receives:		struct ScrubStatistics* statistics	:	Structure to copy the counters to.
+*  Returns:		Nothing
+***************************************************************************/
+void GetScrubStatistics(struct ScrubStatistics* statistics)
+{
+	*statistics = scrub.statistics;
+}
+
+/***************************************************************************
+*  Function:		ResetScrubStatistics()
+*  Description:		Clears the scrub counters.
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+void ResetScrubStatistics(void)
+{
+	memset(&scrub.statistics, 0, sizeof(scrub.statistics));
+}
+
+/***************************************************************************
+*  Function:		ClaimAccess()
+*  Description:		Checks if one more access fits in the budget of this call and the LCD is ready
+				for it. After the previous access the busy flag is read first, this read
+				counts against the budget as well. Takes the transactions from the budget.
+*  Receives:		Nothing
+*  Returns:		TRUE when the access may be done, FALSE when the budget is used or the LCD is busy.
+***************************************************************************/
+static BOOL ClaimAccess(void)
+{
+	if(scrub.ready == FALSE)
+	{
+		if(scrub.budget < 2)
+			return FALSE;
+
+		scrub.budget--;
+		if(ReadBusyFlag() == TRUE)
+		{
+			/* Stop for this call, the LCD is not waited for */
+			scrub.budget = 0;
+			return FALSE;
+		}
+	}
+
+	if(scrub.budget == 0)
+		return FALSE;
+
+	scrub.budget--;
+	scrub.ready = FALSE;
+	return TRUE;
+}
+
+/***************************************************************************
+*  Function:		CheckSlice()
+*  Description:		Reads back as many characters from the current position as the budget allows
+				and marks the characters that differ from the shadow for repair. Each read is
+				preceded by a busy flag read. The address is only set when the address counter
+				does not point to the character, so while incrementing a slice needs one address
+				instruction and while decrementing every character needs one.
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+static void CheckSlice(void)
+{
+	BYTE line = (scrub.position / LINE_LENGTH) + 1;
+	BYTE pos = scrub.position % LINE_LENGTH;
+	BYTE length = 0;
+	BYTE mismatches = 0;
+
+	/* A slice does not cross the end of the line */
+	while((pos + length) < LINE_LENGTH)
+	{
+		BYTE addressInstruction = SET_DDRAM_ADDRESS | (((line-1) << 6) + pos + length);
+
+		/* Set the address unless the address counter already points to the character */
+		if(GetShadowAddressInstruction() != addressInstruction)
+		{
+			if(ClaimAccess() == FALSE)
+				break;
+			WriteLcdNoWait(addressInstruction, INSTRUCTION_REGISTER);
+		}
+
+		if(ClaimAccess() == FALSE)
+			break;
+
+		if(ReadLcd(DATA_REGISTER) != GetShadowCharacter(line, pos + length))
+		{
+			scrub.repairMask |= ((uint16_t)1 << (pos + length));
+			mismatches++;
+		}
+		length++;
+	}
+	scrub.repairLine = line;
+	scrub.statistics.cellsChecked += length;
+
+	/* Continue with the next slice on the next call */
+	scrub.position += length;
+	if(scrub.position >= (2 * LINE_LENGTH))
+		scrub.position = 0;
+
+	/* A completely wrong slice means the content is lost, restore everything at once */
+	if(mismatches >= SCRUB_RESET_THRESHOLD && mismatches == length)
+		Recover();
+}
+
+/***************************************************************************
+*  Function:		RepairCells()
+*  Description:		Rewrites the characters marked for repair with the shadow content, as far as the
+				budget allows. Adjacent characters share one address instruction.
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+static void RepairCells(void)
+{
+	for(BYTE pos = 0; pos < LINE_LENGTH; pos++)
+	{
+		if(scrub.repairMask & ((uint16_t)1 << pos))
+		{
+			BYTE addressInstruction = SET_DDRAM_ADDRESS | (((scrub.repairLine-1) << 6) + pos);
+
+			/* Set the address unless the address counter already points to it (not in CGRAM) */
+			if(GetShadowAddressInstruction() != addressInstruction)
+			{
+				if(ClaimAccess() == FALSE)
+					return;
+				WriteLcdNoWait(addressInstruction, INSTRUCTION_REGISTER);
+			}
+
+			if(ClaimAccess() == FALSE)
+				return;
+			WriteLcdNoWait(GetShadowCharacter(scrub.repairLine, pos), DATA_REGISTER);
+
+			scrub.repairMask &= ~((uint16_t)1 << pos);
+			scrub.statistics.corruptedCells++;
+		}
+	}
+}
+
+/***************************************************************************
+*  Function:		Recover()
+*  Description:		Restores the configuration and complete content of the LCD, any pending repairs
+				are part of this. This is the only part of the scrub that waits for the LCD.
+				Afterwards the restore handler can restore the CGRAM content.
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+static void Recover(void)
+{
+	RestoreDisplay();
+
+	scrub.repairMask = 0;
+	scrub.statistics.controllerResets++;
+
+	if(scrub.restoreHandler != 0)
+		scrub.restoreHandler();
+}
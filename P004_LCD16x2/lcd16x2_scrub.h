@@ -0,0 +1,64 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project: 		LCD 16x2 Library
+ * Hardware:		Arduino UNO
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_scrub.h
+ * Purpose: 		LCD 16x2 background DDRAM scrub header
+ * Date:			18-10-2026
+ * Author:		Marcel van der Ven
+ *
+ * Hardware setup:
+ *
+ * Note(s):		ScrubTask() verifies a small slice of the display each call against the shadow of the
+ *				driver and rewrites only the characters that differ. The number of bus transactions
+ *				per call, busy flag reads included, is limited by the budget given to InitializeScrub.
+ *				Each transaction takes about 3 us. A restore after a detected LCD reset is the only
+ *				exception, it waits for the LCD and rewrites the complete display. CGRAM is not part
+ *				of the shadow, set a restore handler (SetScrubRestoreHandler) to load the glyphs again.
+ *
+ *				With the entry mode set to shift the display (SetEntryMode(..., TRUE)) every repaired
+ *				character shifts the display, like any other write. Reading back does not shift.
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+
+#ifndef LCD16X2_SCRUB_H_
+#define LCD16X2_SCRUB_H_
+
+
+#include "common.h"
+#include "lcd16x2.h"
+
+/************************************************************************/
+/* Defines				                                                                  */
+/************************************************************************/
+/* Status read, address instruction, busy flag read and one character read */
+#define SCRUB_MINIMUM_BUDGET		4
+
+/************************************************************************/
+/* Structures				                                                                  */
+/************************************************************************/
+struct ScrubStatistics
+{
+	/* Number of characters read back and compared */
+	uint16_t cellsChecked;
+
+	/* Number of characters that differed and have been rewritten */
+	uint16_t corruptedCells;
+
+	/* Number of times the LCD was found reset and has been restored */
+	uint16_t controllerResets;
+};
+
+/************************************************************************/
+/* API					                                                                  */
+/************************************************************************/
+void InitializeScrub(BYTE transactionsPerTick);
+void SetScrubRestoreHandler(void (*restoreHandler)(void));
+void ScrubTask(void);
+
+void GetScrubStatistics(struct ScrubStatistics* statistics);
+void ResetScrubStatistics(void);
+
+#endif /* LCD16X2_SCRUB_H_ */
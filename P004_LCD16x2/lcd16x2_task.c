@@ -0,0 +1,201 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project:		Library for LCD 16x2
+ * Hardware:		LCD Display 16x2 type YM1602C
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_task.c
+ * Purpose: 		LCD 16x2 polled (non-blocking) task driver
+ * Date:			18-10-2026
+ * Version:		1.0
+ * Author:		Marcel van der Ven
+ *
+ * Release notes:	Oct. 18, 2026:	1.0 - Initial Release
+ *
+ * Note(s):		Commands are stored in a caller-provided ring buffer and sent by LcdTask(),
+ *				one per call and only when the busy flag is cleared. Nothing in this file waits.
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+/************************************************************************/
+/* Defines				                                                                  */
+/************************************************************************/
+#define SET_DDRAM_ADDRESS	0b10000000
+#define CLEAR_CHAR		0x20
+
+/************************************************************************/
+/* Includes				                                                                  */
+/************************************************************************/
+#include "lcd16x2_task.h"
+#include "string.h"
+
+
+/************************************************************************/
+/* Structures				                                                                  */
+/************************************************************************/
+static struct LcdTaskQueue
+{
+	struct LcdCommand* buffer;
+	BYTE size;
+
+	/* Index of the oldest queued command and the number of queued commands */
+	BYTE head;
+	BYTE count;
+
+	/* Address instruction for where the next queued data byte belongs, only valid */
+	/* after the first command has been sent */
+	BYTE addressInstruction;
+	BOOL addressKnown;
+} queue;
+
+
+/************************************************************************/
+/* Functions				                                                                  */
+/************************************************************************/
+
+/***************************************************************************
+*  Function:		InitializeLcdTask(struct LcdCommand* buffer, BYTE size)
+*  Description:		Initializes the task driver with the given command buffer, any queued
+				commands are discarded. InitializeLcd must be called before LcdTask is used.
+*  Receives:		struct LcdCommand* buffer	:	Buffer to queue the commands in.
+				BYTE size					:	Number of commands the buffer can hold.
+*  Returns:		Nothing
+***************************************************************************/
+void InitializeLcdTask(struct LcdCommand* buffer, BYTE size)
+{
+	queue.buffer = buffer;
+	queue.size = size;
+	queue.head = 0;
+	queue.count = 0;
+	queue.addressKnown = FALSE;
+}
+
+/***************************************************************************
+*  Function:		QueueLcdCommand(BYTE dataToWrite, RegType regType)
+*  Description:		Adds the given byte for the given register to the command queue.
+*  Receives:		BYTE dataToWrite			:	Byte to write.
+				RegType regType			:	Type of register to write to.
+*  Returns:		TRUE when queued, FALSE when the queue is full.
+***************************************************************************/
+BOOL QueueLcdCommand(BYTE dataToWrite, RegType regType)
+{
+	if(queue.count >= queue.size)
+		return FALSE;
+
+	/* Calculate the first free slot behind the queued commands, head + count can overflow a BYTE */
+	BYTE index;
+	if(queue.count < (queue.size - queue.head))
+		index = queue.head + queue.count;
+	else
+		index = queue.count - (queue.size - queue.head);
+
+	queue.buffer[index].data = dataToWrite;
+	queue.buffer[index].regType = regType;
+	queue.count++;
+
+	return TRUE;
+}
+
+/***************************************************************************
+*  Function:		QueueWriteToPosition(char* string, BYTE line, BYTE pos, BYTE positionsToClear)
+*  Description:		Queued version of WriteToPosition. The clearing and writing is combined in one
+				pass, so only one address instruction is queued. Either all commands are queued
+				or none.
+*  Receives:		char* string		:	Pointer to the string to write
+				BYTE line			:	The line to write to.
+				BYTE pos			:	The position on the line (zero-based)
+				BYTE positionsToClear:	Number of characters positions to clear from position onwards.
+*  Returns:		TRUE when queued, FALSE on invalid arguments or insufficient queue space.
+***************************************************************************/
+BOOL QueueWriteToPosition(char* string, BYTE line, BYTE pos, BYTE positionsToClear)
+{
+	int length = strlen(string);
+
+	/* Same limits as WriteToPosition, we don't use shift so maximum length of a line is 16 */
+	if(line < LINE1 || line > LINE2 || pos > LINE_LENGTH || length > (LINE_LENGTH - pos))
+		return FALSE;
+
+	/* Positions to clear beyond the end of the line are ignored */
+	if(positionsToClear > (LINE_LENGTH - pos))
+		positionsToClear = LINE_LENGTH - pos;
+
+	/* Number of characters to send, the string and trailing cleared positions */
+	BYTE characters = (length > positionsToClear) ? length : positionsToClear;
+
+	/* One address instruction plus the characters */
+	if((queue.size - queue.count) < (characters + 1))
+		return FALSE;
+
+	/* Calculate start address, bit 6 is 0 for line 1 and 1 for line 2 */
+	BYTE address = ((line-1) << 6) + pos;
+	QueueLcdCommand(SET_DDRAM_ADDRESS | address, INSTRUCTION_REGISTER);
+
+	for(int i = 0; i < characters; i++)
+	{
+		QueueLcdCommand((i < length) ? string[i] : CLEAR_CHAR, DATA_REGISTER);
+	}
+
+	return TRUE;
+}
+
+/***************************************************************************
+*  Function:		GetQueuedCommandCount()
+*  Description:		Returns the number of commands that still need to be sent.
+*  Receives:		Nothing
+*  Returns:		Number of queued commands.
+***************************************************************************/
+BYTE GetQueuedCommandCount(void)
+{
+	return queue.count;
+}
+
+/***************************************************************************
+*  Function:		LcdTask()
+*  Description:		Sends the oldest queued command when the LCD is ready, needs to be called
+				periodically from the main loop. Never waits: when the busy flag is set the
+				function returns and the command is sent on a later call.
+				When the address counter was moved by another function since the previous
+				command, the address is restored first and the data is sent on the next call.
+
+				Worst-case execution time is one busy flag read plus one write, both
+				about 3 us of bus delays (see ReadLcd and WriteLcdNoWait).
+*  Receives:		Nothing
+*  Returns:		TRUE when a command was sent, FALSE when idle or the LCD is busy.
+***************************************************************************/
+BOOL LcdTask(void)
+{
+	if(queue.count == 0)
+		return FALSE;
+
+	/* The busy flag can only be polled after the setup-phase, same as WriteLcd */
+	if(IsSetupCompleted() == TRUE && ReadBusyFlag() == TRUE)
+		return FALSE;
+
+	struct LcdCommand* command = &queue.buffer[queue.head];
+
+	/* Other driver functions may have moved the address counter between two calls, put it */
+	/* back first so the data ends up where it was queued for. The data follows next call. */
+	if(command->regType == DATA_REGISTER && queue.addressKnown == TRUE &&
+	   GetShadowAddressInstruction() != queue.addressInstruction)
+	{
+		WriteLcdNoWait(queue.addressInstruction, INSTRUCTION_REGISTER);
+		return TRUE;
+	}
+
+	WriteLcdNoWait(command->data, command->regType);
+
+	/* Remember where the next data byte of this queue belongs */
+	queue.addressInstruction = GetShadowAddressInstruction();
+	queue.addressKnown = TRUE;
+
+	/* Remove the command from the queue */
+	queue.head++;
+	if(queue.head >= queue.size)
+		queue.head = 0;
+	queue.count--;
+
+	/* Only commands queued together are kept at their address, a new run starts where the address counter is */
+	if(queue.count == 0)
+		queue.addressKnown = FALSE;
+
+	return TRUE;
+}
@@ -0,0 +1,50 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project: 		LCD 16x2 Library
+ * Hardware:		Arduino UNO
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_task.h
+ * Purpose: 		LCD 16x2 polled (non-blocking) task driver header
+ * Date:			18-10-2026
+ * Author:		Marcel van der Ven
+ *
+ * Hardware setup:
+ *
+ * Note(s):		LcdTask() is meant to be called from the main loop as often as possible.
+ *				Each call performs at most one busy flag read and one write transaction,
+ *				so the worst-case execution time at 16 MHz is about 7 us (6 us of fixed
+ *				bus delays plus port handling), independent of the queued content. With coalescing
+ *				enabled a Clear Display also drops the pending frame characters, one short loop step
+ *				per pending character.
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+
+#ifndef LCD16X2_TASK_H_
+#define LCD16X2_TASK_H_
+
+
+#include "common.h"
+#include "lcd16x2.h"
+
+/************************************************************************/
+/* Structures				                                                                  */
+/************************************************************************/
+struct LcdCommand
+{
+	BYTE data;
+	BYTE regType;
+};
+
+/************************************************************************/
+/* API					                                                                  */
+/************************************************************************/
+void InitializeLcdTask(struct LcdCommand* buffer, BYTE size);
+
+BOOL QueueLcdCommand(BYTE dataToWrite, RegType regType);
+BOOL QueueWriteToPosition(char* string, BYTE line, BYTE pos, BYTE positionsToClear);
+BYTE GetQueuedCommandCount(void);
+
+BOOL LcdTask(void);
+
+#endif /* LCD16X2_TASK_H_ */
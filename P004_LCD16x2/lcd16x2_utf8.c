@@ -0,0 +1,378 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project:		Library for LCD 16x2
+ * Hardware:		LCD Display 16x2 type YM1602C
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_utf8.c
+ * Purpose: 		LCD 16x2 UTF-8 to character ROM translation
+ * Date:			18-10-2026
+ * Version:		1.0
+ * Author:		Marcel van der Ven
+ *
+ * Release notes:	Oct. 18, 2026:	1.0 - Initial Release
+ *
+ * Note(s):		ASCII is passed on directly. Other characters are looked up in a sorted table in flash
+ *				(binary search), characters that are not in the ROM get a CGRAM glyph from a second
+ *				flash table. The CGRAM characters are reused round-robin, so when more different
+ *				glyphs are needed than LCD_UTF8_CGRAM_COUNT, characters already on the display change.
+ *				After the LCD has been reset or other glyphs have been loaded into the same CGRAM
+ *				characters, InvalidateUtf8Glyphs makes the translation load its glyphs again. Call it
+ *				from the restore handler of the scrub (SetScrubRestoreHandler).
+ *
+ *				A00: the upper half holds katakana, some Greek and accented characters. 0x5C is the
+ *				yen sign and 0x7E and 0x7F are arrows, so backslash and tilde need a CGRAM glyph.
+ *				A02: the upper half (0xA0 - 0xFF) follows ISO 8859-1.
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+/************************************************************************/
+/* Defines				                                                                  */
+/************************************************************************/
+#define INVALID_CODE_POINT		0xFFFF
+
+/* Character codes 0x08 - 0x0F show CGRAM characters 0 - 7, unlike 0x00 they can be used in strings */
+#define CGRAM_CHARACTER_CODE		0x08
+
+/************************************************************************/
+/* Includes				                                                                  */
+/************************************************************************/
+#include <avr/pgmspace.h>
+#include "lcd16x2_utf8.h"
+#include "string.h"
+
+
+/************************************************************************/
+/* Structures				                                                                  */
+/************************************************************************/
+struct RomCharacter
+{
+	uint16_t codePoint;
+	BYTE code;
+};
+
+struct CgramGlyph
+{
+	uint16_t codePoint;
+	BYTE rows[8];
+};
+
+
+/************************************************************************/
+/* Tables				                                                                  */
+/************************************************************************/
+#if LCD_CHARACTER_ROM == LCD_ROM_A00
+/* Characters in the A00 ROM, sorted on code point */
+static const struct RomCharacter romCharacters[] PROGMEM =
+{
+	{ 0x00A2, 0xEC },	/* cent sign */
+	{ 0x00A5, 0x5C },	/* yen sign */
+	{ 0x00B0, 0xDF },	/* degree sign */
+	{ 0x00B5, 0xE4 },	/* micro sign */
+	{ 0x00B7, 0xA5 },	/* middle dot */
+	{ 0x00DF, 0xE2 },	/* sharp s, shown as beta */
+	{ 0x00E4, 0xE1 },	/* a umlaut */
+	{ 0x00F1, 0xEE },	/* n tilde */
+	{ 0x00F6, 0xEF },	/* o umlaut */
+	{ 0x00F7, 0xFD },	/* division sign */
+	{ 0x00FC, 0xF5 },	/* u umlaut */
+	{ 0x03A3, 0xF6 },	/* capital sigma */
+	{ 0x03A9, 0xF4 },	/* capital omega */
+	{ 0x03B1, 0xE0 },	/* alpha */
+	{ 0x03B2, 0xE2 },	/* beta */
+	{ 0x03B5, 0xE3 },	/* epsilon */
+	{ 0x03B8, 0xF2 },	/* theta */
+	{ 0x03BC, 0xE4 },	/* mu */
+	{ 0x03C0, 0xF7 },	/* pi */
+	{ 0x03C1, 0xE6 },	/* rho */
+	{ 0x03C3, 0xE5 },	/* sigma */
+	{ 0x2126, 0xF4 },	/* ohm sign */
+	{ 0x2190, 0x7F },	/* left arrow */
+	{ 0x2192, 0x7E },	/* right arrow */
+	{ 0x221A, 0xE8 },	/* square root */
+	{ 0x221E, 0xF3 },	/* infinity */
+	{ 0x2588, 0xFF },	/* full block */
+	{ 0x3002, 0xA1 }	/* ideographic full stop */
+};
+
+#define ROM_CHARACTER_COUNT		(sizeof(romCharacters) / sizeof(romCharacters[0]))
+#endif
+
+#if LCD_UTF8_CGRAM_COUNT > 0
+/* Glyphs for characters that are not in the ROM */
+static const struct CgramGlyph cgramGlyphs[] PROGMEM =
+{
+	{ 0x005C, { 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00 } },	/* backslash */
+	{ 0x007E, { 0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00, 0x00 } },	/* tilde */
+	{ 0x00C4, { 0x0A, 0x00, 0x0E, 0x11, 0x1F, 0x11, 0x11, 0x00 } },	/* A umlaut */
+	{ 0x00D6, { 0x0A, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E, 0x00 } },	/* O umlaut */
+	{ 0x00DC, { 0x0A, 0x00, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00 } },	/* U umlaut */
+	{ 0x0394, { 0x00, 0x04, 0x04, 0x0A, 0x0A, 0x11, 0x1F, 0x00 } },	/* capital delta */
+	{ 0x03B3, { 0x00, 0x00, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 } },	/* gamma */
+	{ 0x03BB, { 0x08, 0x04, 0x04, 0x0A, 0x0A, 0x11, 0x11, 0x00 } }	/* lambda */
+};
+
+#define CGRAM_GLYPH_COUNT		(sizeof(cgramGlyphs) / sizeof(cgramGlyphs[0]))
+#endif
+
+
+/************************************************************************/
+/* Structures				                                                                  */
+/************************************************************************/
+#if LCD_UTF8_CGRAM_COUNT > 0
+static struct Utf8Glyphs
+{
+	/* Glyph shown by each CGRAM character, index in cgramGlyphs plus 1 (0 is unused) */
+	BYTE loaded[LCD_UTF8_CGRAM_COUNT];
+
+	/* CGRAM character to replace when all are used */
+	BYTE next;
+} utf8Glyphs;
+#endif
+
+
+/************************************************************************/
+/* Local Function Prototypes		                                                                  */
+/************************************************************************/
+static uint16_t DecodeUtf8(const char** utf8);
+static BYTE LookupRom(uint16_t codePoint);
+static BYTE LookupCgram(uint16_t codePoint);
+
+
+/************************************************************************/
+/* Functions				                                                                  */
+/************************************************************************/
+
+/***************************************************************************
+*  Function:		TranslateUtf8(const char** utf8)
+*  Description:		Translates the next UTF-8 character to a character code of the LCD and moves
+				the pointer to the character after it.
+*  Receives:		const char** utf8	:	Pointer to the UTF-8 string pointer, must not point to the end.
+*  Returns:		The character code, or UNKNOWN_CHAR when it can not be displayed.
+***************************************************************************/
+BYTE TranslateUtf8(const char** utf8)
+{
+	BYTE first = (BYTE)**utf8;
+
+#if LCD_CHARACTER_ROM == LCD_ROM_A00
+	/* Most characters are ASCII, the A00 ROM differs only for backslash and tilde */
+	if(first < 0x80 && first != '\\' && first != '~')
+#else
+	if(first < 0x80)
+#endif
+	{
+		(*utf8)++;
+		return first;
+	}
+
+	uint16_t codePoint = DecodeUtf8(utf8);
+	if(codePoint == INVALID_CODE_POINT)
+		return UNKNOWN_CHAR;
+
+	BYTE code = LookupRom(codePoint);
+	if(code == 0)
+		code = LookupCgram(codePoint);
+
+	return (code != 0) ? code : UNKNOWN_CHAR;
+}
+
+/***************************************************************************
+*  Function:		TranslateUtf8String(const char* utf8, char* buffer, BYTE size)
+*  Description:		Translates the UTF-8 string into LCD character codes, the result is terminated.
+*  Receives:		const char* utf8	:	The UTF-8 string.
+				char* buffer		:	Buffer for the translated string.
+				BYTE size			:	Size of the buffer, longer strings are cut off.
+*  Returns:		Number of characters in the translated string, 0 when the size is 0.
+***************************************************************************/
+BYTE TranslateUtf8String(const char* utf8, char* buffer, BYTE size)
+{
+	BYTE length = 0;
+
+	/* No room for the terminator */
+	if(size == 0)
+		return 0;
+
+	while(*utf8 != 0 && length < (size - 1))
+	{
+		buffer[length++] = TranslateUtf8(&utf8);
+	}
+	buffer[length] = 0;
+
+	return length;
+}
+
+/***************************************************************************
+*  Function:		InvalidateUtf8Glyphs()
+*  Description:		Forgets which glyphs are loaded into the CGRAM characters of the translation,
+				they are loaded again when used. Needed after a reset of the LCD (RestoreDisplay
+				does not restore CGRAM) or when other glyphs were written to these characters.
+*  Receives:		Nothing
+*  Returns:		Nothing
+***************************************************************************/
+void InvalidateUtf8Glyphs(void)
+{
+#if LCD_UTF8_CGRAM_COUNT > 0
+	memset(utf8Glyphs.loaded, 0, sizeof(utf8Glyphs.loaded));
+	utf8Glyphs.next = 0;
+#endif
+}
+
+/***************************************************************************
+*  Function:		WriteUtf8ToPosition(const char* utf8, BYTE line, BYTE pos, BYTE positionsToClear)
+*  Description:		WriteToPosition for an UTF-8 string, at most one line (16 characters) is written.
+*  Receives:		const char* utf8	:	The UTF-8 string to write
+				BYTE line			:	The line to write to.
+				BYTE pos			:	The position on the line (zero-based)
+				BYTE positionsToClear:	Number of characters positions to clear from position onwards.
+*  Returns:		Nothing
+***************************************************************************/
+void WriteUtf8ToPosition(const char* utf8, BYTE line, BYTE pos, BYTE positionsToClear)
+{
+	char buffer[LINE_LENGTH + 1];
+
+	/* Translate first, loading a CGRAM glyph moves the address counter */
+	TranslateUtf8String(utf8, buffer, sizeof(buffer));
+	WriteToPosition(buffer, line, pos, positionsToClear);
+}
+
+/***************************************************************************
+*  Function:		WriteUtf8NewLine(const char* utf8, BYTE line)
+*  Description:		WriteNewLine for an UTF-8 string.
+*  Receives:		const char* utf8	:	The UTF-8 string to write
+				BYTE line			:	The line to write to.
+*  Returns:		Nothing
+***************************************************************************/
+void WriteUtf8NewLine(const char* utf8, BYTE line)
+{
+	WriteUtf8ToPosition(utf8, line, 0, LINE_LENGTH);
+}
+
+/***************************************************************************
+*  Function:		DecodeUtf8(const char** utf8)
+*  Description:		Decodes the next UTF-8 sequence and moves the pointer behind it. Only the
+				Basic Multilingual Plane (up to 3 bytes) is supported.
+*  Receives:		const char** utf8	:	Pointer to the UTF-8 string pointer.
+*  Returns:		The code point, or INVALID_CODE_POINT for invalid or unsupported sequences.
+***************************************************************************/
+static uint16_t DecodeUtf8(const char** utf8)
+{
+	const BYTE* next = (const BYTE*)*utf8;
+	uint16_t codePoint = INVALID_CODE_POINT;
+	BYTE continuationBytes = 0;
+
+	if(*next < 0x80)
+	{
+		codePoint = *next;
+	}
+	else if((*next & 0xE0) == 0xC0)
+	{
+		codePoint = *next & 0x1F;
+		continuationBytes = 1;
+	}
+	else if((*next & 0xF0) == 0xE0)
+	{
+		codePoint = *next & 0x0F;
+		continuationBytes = 2;
+	}
+	next++;
+
+	/* Unsupported lead byte, skip the rest of the sequence */
+	if(codePoint == INVALID_CODE_POINT)
+	{
+		while((*next & 0xC0) == 0x80)
+			next++;
+	}
+
+	for(; continuationBytes > 0; continuationBytes--)
+	{
+		/* A missing continuation byte makes the sequence invalid, the byte itself is kept */
+		if((*next & 0xC0) != 0x80)
+		{
+			codePoint = INVALID_CODE_POINT;
+			break;
+		}
+		codePoint = (codePoint << 6) | (*next & 0x3F);
+		next++;
+	}
+
+	*utf8 = (const char*)next;
+	return codePoint;
+}
+
+/***************************************************************************
+*  Function:		LookupRom(uint16_t codePoint)
+*  Description:		Finds the character code of the code point in the character ROM.
+*  Receives:		uint16_t codePoint	:	The code point to find.
+*  Returns:		The character code, or 0 when the ROM does not contain the character.
+***************************************************************************/
+static BYTE LookupRom(uint16_t codePoint)
+{
+#if LCD_CHARACTER_ROM == LCD_ROM_A00
+	BYTE low = 0;
+	BYTE high = ROM_CHARACTER_COUNT;
+
+	/* Binary search in the sorted table */
+	while(low < high)
+	{
+		BYTE middle = (low + high) / 2;
+		uint16_t middleCodePoint = pgm_read_word(&romCharacters[middle].codePoint);
+
+		if(middleCodePoint == codePoint)
+			return pgm_read_byte(&romCharacters[middle].code);
+
+		if(middleCodePoint < codePoint)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+#else
+	if(codePoint >= 0x00A0 && codePoint <= 0x00FF)
+		return (BYTE)codePoint;
+#endif
+
+	return 0;
+}
+
+/***************************************************************************
+*  Function:		LookupCgram(uint16_t codePoint)
+*  Description:		Returns the character code of the CGRAM glyph for the code point, the glyph is
+				loaded into CGRAM when it is not loaded yet.
+*  Receives:		uint16_t codePoint	:	The code point to find.
+*  Returns:		The character code, or 0 when there is no glyph for the character.
+***************************************************************************/
+static BYTE LookupCgram(uint16_t codePoint)
+{
+#if LCD_UTF8_CGRAM_COUNT > 0
+	BYTE glyph;
+
+	for(glyph = 0; glyph < CGRAM_GLYPH_COUNT; glyph++)
+	{
+		if(pgm_read_word(&cgramGlyphs[glyph].codePoint) == codePoint)
+			break;
+	}
+	if(glyph == CGRAM_GLYPH_COUNT)
+		return 0;
+
+	/* Use the CGRAM character when the glyph is already loaded */
+	for(BYTE slot = 0; slot < LCD_UTF8_CGRAM_COUNT; slot++)
+	{
+		if(utf8Glyphs.loaded[slot] == glyph + 1)
+			return CGRAM_CHARACTER_CODE + LCD_UTF8_CGRAM_FIRST + slot;
+	}
+
+	/* Load the glyph into the next CGRAM character */
+	BYTE slot = utf8Glyphs.next;
+	utf8Glyphs.next = (slot + 1 < LCD_UTF8_CGRAM_COUNT) ? slot + 1 : 0;
+	utf8Glyphs.loaded[slot] = glyph + 1;
+
+	SetCharacterGeneratorAddress((LCD_UTF8_CGRAM_FIRST + slot) * 8);
+	for(BYTE row = 0; row < 8; row++)
+	{
+		WriteDataReg(pgm_read_byte(&cgramGlyphs[glyph].rows[row]));
+	}
+
+	return CGRAM_CHARACTER_CODE + LCD_UTF8_CGRAM_FIRST + slot;
+#else
+	(void)codePoint;
+	return 0;
+#endif
+}
@@ -0,0 +1,71 @@
+/*--------------------------------------------------------------------------------------------------------------------------------------------------------
+ * Project: 		LCD 16x2 Library
+ * Hardware:		Arduino UNO
+ * Micro:			ATMEGA328P
+ * IDE:			Atmel Studio 6.2
+ *
+ * Name:    		lcd16x2_utf8.h
+ * Purpose: 		LCD 16x2 UTF-8 to character ROM translation header
+ * Date:			18-10-2026
+ * Author:		Marcel van der Ven
+ *
+ * Hardware setup:
+ *
+ * Note(s):		Fixed texts should use the LCD_STR_ defines below instead of UTF-8, the compiler
+ *				concatenates them with the surrounding literals so nothing is translated at runtime:
+ *
+ *				WriteNewLine("Temp: 25" LCD_STR_DEGREE "C", LINE1);
+ *--------------------------------------------------------------------------------------------------------------------------------------------------------*/
+
+
+#ifndef LCD16X2_UTF8_H_
+#define LCD16X2_UTF8_H_
+
+
+#include "common.h"
+#include "lcd16x2.h"
+
+/************************************************************************/
+/* Defines				                                                                  */
+/************************************************************************/
+/* Character used for characters that can not be displayed */
+#define UNKNOWN_CHAR			'?'
+
+/* Character ROM codes as string literals */
+#if LCD_CHARACTER_ROM == LCD_ROM_A00
+#define LCD_STR_DEGREE		"\xDF"
+#define LCD_STR_MICRO			"\xE4"
+#define LCD_STR_A_UMLAUT		"\xE1"
+#define LCD_STR_O_UMLAUT		"\xEF"
+#define LCD_STR_U_UMLAUT		"\xF5"
+#define LCD_STR_ALPHA			"\xE0"
+#define LCD_STR_BETA			"\xE2"
+#define LCD_STR_EPSILON		"\xE3"
+#define LCD_STR_SIGMA			"\xE5"
+#define LCD_STR_RHO			"\xE6"
+#define LCD_STR_THETA			"\xF2"
+#define LCD_STR_PI			"\xF7"
+#define LCD_STR_OMEGA			"\xF4"
+#define LCD_STR_SUM			"\xF6"
+#define LCD_STR_SQRT			"\xE8"
+#define LCD_STR_INFINITY		"\xF3"
+#define LCD_STR_RIGHT_ARROW		"\x7E"
+#define LCD_STR_LEFT_ARROW		"\x7F"
+#else
+#define LCD_STR_DEGREE		"\xB0"
+#define LCD_STR_MICRO			"\xB5"
+#define LCD_STR_A_UMLAUT		"\xE4"
+#define LCD_STR_O_UMLAUT		"\xF6"
+#define LCD_STR_U_UMLAUT		"\xFC"
+#endif
+
+/************************************************************************/
+/* API					                                                                  */
+/************************************************************************/
+BYTE TranslateUtf8(const char** utf8);
+BYTE TranslateUtf8String(const char* utf8, char* buffer, BYTE size);
+void InvalidateUtf8Glyphs(void);
+void WriteUtf8ToPosition(const char* utf8, BYTE line, BYTE pos, BYTE positionsToClear);
+void WriteUtf8NewLine(const char* utf8, BYTE line);
+
+#endif /* LCD16X2_UTF8_H_ */